@@ -34,8 +34,10 @@
 
 #include <GU/GU_DetailHandle.h>
 #include <ROP/ROP_Node.h>
+#include <UT/UT_StringHolder.h>
 
 #include "ROP_FBXExporterWrapper.h"
+#include "ROP_FBXExportStats.h"
 
 #define FBX_FLOAT_PARM(name, vi, t)	\
 		{ return evalFloat(name, vi, t); }
@@ -58,6 +60,10 @@ enum {
     ROP_FBX_MKPATH,
     ROP_FBX_BUILDFROMPATH,
     ROP_FBX_PATHATTRIB,
+    ROP_FBX_PARALLELPATHS,
+    ROP_FBX_SPLITEXPORT,
+    ROP_FBX_SPLITOUTPUT,
+    ROP_FBX_SEQUENCE,
 
     ROP_FBX_SWITCHER,
     ROP_FBX_EXPORTASCII,
@@ -82,6 +88,18 @@ enum {
     ROP_FBX_COMPUTESMOOTHINGGROUPS,
     ROP_FBX_EXPORTCLIPS,
     ROP_FBX_NUMCLIPS,
+    ROP_FBX_PROFILEOUTPUT,
+    ROP_FBX_REPORTMEMORY,
+    ROP_FBX_STATSOUTPUT,
+    ROP_FBX_ESTIMATEONLY,
+    ROP_FBX_THREADS,
+    ROP_FBX_COMPRESSIONLEVEL,
+    ROP_FBX_BACKGROUNDWRITE,
+    ROP_FBX_SKIPUNCHANGED,
+    ROP_FBX_STAGELOCALLY,
+    ROP_FBX_CHECKPOINTS,
+    ROP_FBX_RESUME,
+    ROP_FBX_MAXMESSAGES,
 
     ROP_FBX_TPRERENDER,
     ROP_FBX_PRERENDER,
@@ -249,6 +267,42 @@ private:
 	return evalIntInst("clipframerange#", &idx, 1, time);
     }
 
+    void PROFILEOUTPUT(UT_String& str, fpreal t)
+    { STR_PARM("profileoutput", 0, t); }
+
+    bool REPORTMEMORY(fpreal t) const
+    { INT_PARM("reportmemory", 0, t); }
+
+    void STATSOUTPUT(UT_String& str, fpreal t)
+    { STR_PARM("statsoutput", 0, t); }
+
+    bool ESTIMATEONLY(fpreal t) const
+    { INT_PARM("estimateonly", 0, t); }
+
+    int THREADS(fpreal t) const
+    { INT_PARM("threads", 0, t); }
+
+    int COMPRESSIONLEVEL(fpreal t) const
+    { INT_PARM("compressionlevel", 0, t); }
+
+    bool BACKGROUNDWRITE(fpreal t) const
+    { INT_PARM("backgroundwrite", 0, t); }
+
+    bool SKIPUNCHANGED(fpreal t) const
+    { INT_PARM("skipunchanged", 0, t); }
+
+    bool STAGELOCALLY(fpreal t) const
+    { INT_PARM("stagelocally", 0, t); }
+
+    bool CHECKPOINTS(fpreal t) const
+    { INT_PARM("checkpoints", 0, t); }
+
+    bool RESUME(fpreal t) const
+    { INT_PARM("resume", 0, t); }
+
+    int MAXMESSAGES(fpreal t) const
+    { INT_PARM("maxmessages", 0, t); }
+
     UT_StringHolder PATH_ATTRIB(fpreal t) const
     {
         UT_StringHolder attrib;
@@ -256,6 +310,19 @@ private:
         return attrib;
     }
 
+    bool PARALLELPATHS(fpreal t) const
+    { INT_PARM("parallelpaths", 0, t); }
+
+    bool SPLITEXPORT(fpreal t) const
+    { INT_PARM("splitexport", 0, t); }
+
+    /// Output file of a split export part. $ASSET is replaced by the name
+    /// of the part's node before the rest of the pattern is expanded.
+    void SPLITOUTPUT(UT_String& str, const char* asset, fpreal t);
+
+    bool SEQUENCE(fpreal t) const
+    { INT_PARM("sequence", 0, t); }
+
 
     // Script commands
     void	PRERENDER(UT_String &str, fpreal t)
@@ -274,8 +341,26 @@ private:
 
 private:
 
+    /// Copies the messages onto this node, and how many warnings were
+    /// suppressed. Only called once the export or its write is over.
+    void reportExportMessages(ROP_FBXErrorManager &error_manager);
+    /// Once the background write of the last export has finished, adds its
+    /// messages to this node and shows its statistics.
+    void updateBackgroundWrite();
+    /// True if this node or the exporter reported a critical error.
+    bool hasExportFailed();
+
     ROP_FBXExporterWrapper myFBXExporter;
     bool myDidCallExport;
+    /// True if each frame is written to its own file by renderFrame().
+    bool myIsSequence;
+    /// The file of the last frame written, to catch frames that would
+    /// overwrite each other.
+    UT_StringHolder myLastSequencePath;
+
+    /// Statistics of the last finished export, shown in the node info.
+    ROP_FBXExportStats myLastStats;
+    bool myHasLastStats;
 };
 
 
@@ -78,6 +78,7 @@ public:
     ROP_FBXBaseNodeVisitInfo* visitBegin(OP_Node* node, int input_idx_on_this_node) override;
     ROP_FBXVisitorResultType visit(OP_Node* node, ROP_FBXBaseNodeVisitInfo* node_info) override;
     void onEndHierarchyBranchVisiting(OP_Node* last_node, ROP_FBXBaseNodeVisitInfo* last_node_info) override;
+    const char* getProgressMessage() const override { return "Exporting animation"; }
 
     void reset(FbxAnimLayer* curr_layer);
 
@@ -86,6 +87,21 @@ public:
             FbxAnimLayer* curr_fbx_anim_layer,
             FbxNode* fbx_node);
 
+    /// Moves the control points of the geometry of fbx_node to where the
+    /// vertex cache of geo_node would put them at time t.
+    bool updateControlPoints(FbxNode* fbx_node, OP_Node* geo_node, ROP_FBXNodeInfo* node_pair_info, fpreal t);
+
+    /// Adds linear keys to fbx_curve sampled from ch, or from
+    /// direct_eval_parm, between the times of start_array_idx and
+    /// end_array_idx in time_array.
+    void outputResampled(FbxAnimCurve* fbx_curve, CH_Channel *ch, int start_array_idx, int end_array_idx, UT_FprealArray& time_array, bool do_insert, PRM_Parm* direct_eval_parm, int parm_idx, double scale_factor = 1.0);
+
+    /// Copies the point positions of gdp into vert_array, in the order the
+    /// control points were exported in, and zeroes the points past the end
+    /// of gdp. For surfaces, only source_prim_cnt is copied if it is not -1.
+    static void gatherVertexArray(const GU_Detail* gdp, bool surfaces_only, int source_prim_cnt,
+				  double* vert_array, int num_array_points);
+
 protected:
 
     void exportResampledAnimation(
@@ -95,7 +111,6 @@ protected:
             ROP_FBXBaseNodeVisitInfo *node_info);
     void exportChannel(FbxAnimCurve* fbx_anim_curve, OP_Node* source_node, const char* parm_name, int parm_idx, double scale_factor = 1.0, const int& param_inst = -1);
 
-    void outputResampled(FbxAnimCurve* fbx_curve, CH_Channel *ch, int start_array_idx, int end_array_idx, UT_FprealArray& time_array, bool do_insert, PRM_Parm* direct_eval_parm, int parm_idx, double scale_factor = 1.0);
     void outputBasicKeys(FbxAnimCurve* fbx_curve, CH_Channel &ch, fpreal start_time, fpreal end_time,
                          double scale_factor, bool detect_constant);
 
@@ -120,6 +135,7 @@ private:
     ROP_FBXExportOptions *myExportOptions;
 
     FbxAnimLayer* myAnimLayer;
+    FbxTime myOneFrameTime;
 
     std::string myOutputFileName, myFBXFileSourceFolder, myFBXShortFileName;
     UT_Interrupt* myBoss;
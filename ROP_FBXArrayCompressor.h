@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2024
+ *	Side Effects Software Inc.  All rights reserved.
+ *
+ * Redistribution and use of in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. The name of Side Effects Software may not be used to endorse or
+ *    promote products derived from this software without specific prior
+ *    written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY SIDE EFFECTS SOFTWARE `AS IS' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN
+ * NO EVENT SHALL SIDE EFFECTS SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * NAME:	ROP_FBXArrayCompressor.h (FBX Library, C++)
+ *
+ * COMMENTS:	Parallel compression of the arrays of binary FBX files.
+ *
+ */
+
+#ifndef __ROP_FBXArrayCompressor_h__
+#define __ROP_FBXArrayCompressor_h__
+
+class UT_WorkBuffer;
+
+/********************************************************************************************************/
+/// Compresses the large arrays of a binary FBX file on several threads.
+///
+/// The FBX SDK deflates arrays one at a time on the thread writing the
+/// file. Instead, the SDK writes them uncompressed, and compressFile()
+/// then copies the file, deflating each array of 1 KB or more in 1 MB
+/// blocks in parallel. The blocks are raw-deflated and sync-flushed, so
+/// they concatenate into a single zlib stream with one header and an
+/// Adler-32 combined from the blocks'. Readers see ordinary compressed
+/// arrays. The offsets of the records are rewritten to match.
+class ROP_FBXArrayCompressor
+{
+public:
+    /// Writes out_file as a copy of the binary FBX file in_file, with its
+    /// uncompressed arrays deflated at the given zlib level, from 1 to 9.
+    /// Arrays that are already compressed are copied as they are.
+    /// @return	False if in_file could not be read as a binary FBX file,
+    ///		out_file could not be written, zlib failed or the copy was
+    ///		interrupted. error_out then holds the reason, and
+    ///		was_interrupted_out tells interruptions apart.
+    static bool compressFile(const char* in_file, const char* out_file, int level,
+			     bool& was_interrupted_out, UT_WorkBuffer& error_out);
+};
+/********************************************************************************************************/
+#endif // __ROP_FBXArrayCompressor_h__
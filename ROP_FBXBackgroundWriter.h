@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2024
+ *	Side Effects Software Inc.  All rights reserved.
+ *
+ * Redistribution and use of in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. The name of Side Effects Software may not be used to endorse or
+ *    promote products derived from this software without specific prior
+ *    written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY SIDE EFFECTS SOFTWARE `AS IS' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN
+ * NO EVENT SHALL SIDE EFFECTS SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * NAME:	ROP_FBXBackgroundWriter.h (FBX Library, C++)
+ *
+ * COMMENTS:	Writes and frees finished FBX scenes on background threads.
+ *
+ */
+
+#ifndef __ROP_FBXBackgroundWriter_h__
+#define __ROP_FBXBackgroundWriter_h__
+
+#include <SYS/SYS_Types.h>
+#include <UT/UT_UniquePtr.h>
+
+class ROP_FBXErrorManager;
+class ROP_FBXExporter;
+struct ROP_FBXExportStats;
+
+/********************************************************************************************************/
+/// Runs ROP_FBXExporter::finishExport() on a background thread, so that the
+/// caller does not wait for the file to be written and the scene to be
+/// destroyed. The exporter is deleted on the background thread once done.
+///
+/// Before a file is exported again, waitForFile() must be called for it.
+/// The messages of a write are reported to whoever waits for it first: the
+/// next export of the same file, its owner through waitForOwner() or
+/// collectWrite(), or, when a ROP node is deleted or the process exits,
+/// waitForAll(), which prints the errors of the writes nobody claimed.
+/// Writes are joined outside of the lock guarding the list of writes, so
+/// waiting for one never blocks the others.
+class ROP_FBXBackgroundWriter
+{
+public:
+    /// Takes over an exporter whose doExport() has finished. owner is an
+    /// arbitrary key for waitForOwner(). If max_writes writes, of any
+    /// owner, are already running, this first waits until one of them has
+    /// finished. Zero or less stands for getMaxWrites(). label, if given,
+    /// is put in front of the messages of the write.
+    ///
+    /// The messages the exporter has so far are cleared, since they are
+    /// the caller's to report; the write only reports its own.
+    /// @return	An id of the write for collectWrite().
+    static exint start(UT_UniquePtr<ROP_FBXExporter> exporter, const void* owner = nullptr,
+		       int max_writes = 0, const char* label = nullptr);
+
+    /// Waits for the background writes of file_name to finish. Their
+    /// messages are added to errors_out, if given.
+    static void waitForFile(const char* file_name, ROP_FBXErrorManager* errors_out);
+
+    /// Collects the writes started by owner and adds their messages to
+    /// errors_out. If wait is false, only writes that have already
+    /// finished are collected.
+    /// @return	False if a collected write reported a critical error.
+    static bool waitForOwner(const void* owner, ROP_FBXErrorManager* errors_out, bool wait);
+
+    /// Collects the write of the given id, once it has finished or, if
+    /// wait is set, after waiting for it. Its messages are added to
+    /// errors_out, and its statistics are copied to stats_out if it has
+    /// any, as told by has_stats_out.
+    /// @return	False if the write is still running. True once it is
+    ///		collected, by this call or earlier by someone else, in
+    ///		which case it has no statistics here.
+    static bool collectWrite(exint write_id, bool wait, ROP_FBXErrorManager* errors_out,
+			     ROP_FBXExportStats& stats_out, bool& has_stats_out);
+
+    /// Waits for all background writes to finish. Their messages are added
+    /// to errors_out if given; otherwise their errors are printed to
+    /// stderr, since no export is left to report them.
+    static void waitForAll(ROP_FBXErrorManager* errors_out = nullptr);
+
+    /// The default number of writes that may run at once, each holding a
+    /// scene.
+    static int getMaxWrites();
+};
+/********************************************************************************************************/
+#endif // __ROP_FBXBackgroundWriter_h__
@@ -136,6 +136,10 @@ public:
 
     virtual void onEndHierarchyBranchVisiting(OP_Node* last_node, ROP_FBXBaseNodeVisitInfo* last_node_info) = 0;
 
+    /// Message of the progress scope open while visitScene() runs. Loops
+    /// inside the visit poll it through ROP_FBXProgressLoop.
+    virtual const char* getProgressMessage() const = 0;
+
     /// Calls visitNodeAndChildren() on the root (given) node.
     void visitScene(OP_Node* start_node);
 
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2024
+ *	Side Effects Software Inc.  All rights reserved.
+ *
+ * Redistribution and use of in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. The name of Side Effects Software may not be used to endorse or
+ *    promote products derived from this software without specific prior
+ *    written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY SIDE EFFECTS SOFTWARE `AS IS' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN
+ * NO EVENT SHALL SIDE EFFECTS SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * NAME:	ROP_FBXCheckpoint.h (FBX Library, C++)
+ *
+ * COMMENTS:	Checkpoints of long per-frame export loops.
+ *
+ */
+
+#ifndef __ROP_FBXCheckpoint_h__
+#define __ROP_FBXCheckpoint_h__
+
+#include <UT/UT_NonCopyable.h>
+#include <SYS/SYS_Types.h>
+
+#include <chrono>
+#include <fstream>
+#include <string>
+
+/********************************************************************************************************/
+/// A file of fixed-size records, one per frame of a long export loop, that
+/// survives a failed export. A re-run resuming from it does not cook the
+/// frames already recorded again; the records either hold what the loop
+/// learned from a frame, or just mark it as done when the frame's result
+/// is already in another file, as with vertex caches.
+///
+/// The file starts with a key describing everything the records depend on
+/// (the export fingerprint, the node, the frame range, ...). Resuming from
+/// a file with a different key starts over. Records are appended in frame
+/// order and flushed about once a second, so a crash loses at most the
+/// last second of frames, and a partly written last record is ignored.
+class ROP_FBXCheckpoint
+{
+public:
+    ROP_FBXCheckpoint();
+    ~ROP_FBXCheckpoint();
+
+    UT_NON_COPYABLE(ROP_FBXCheckpoint)
+
+    /// Opens the checkpoint file. If resume is true and the file has the
+    /// same key and record size, its complete records are kept. Otherwise
+    /// it is started over.
+    bool open(const char* file_name, const std::string& key, exint record_size, bool resume);
+    void close();
+
+    bool isOpen() const { return myFile.is_open(); }
+
+    /// Number of records kept from the previous run plus those appended.
+    exint getNumRecords() const { return myNumRecords; }
+
+    /// Reads one of the first getNumRecords() records.
+    bool readRecord(exint index, void* data);
+    /// Appends a record. index must be getNumRecords().
+    bool appendRecord(exint index, const void* data);
+
+private:
+    std::fstream myFile;
+    std::streamoff myHeaderSize;
+    exint myRecordSize;
+    exint myNumRecords;
+    bool myIsAtEnd;
+    std::chrono::steady_clock::time_point myLastFlush;
+};
+/********************************************************************************************************/
+#endif // __ROP_FBXCheckpoint_h__
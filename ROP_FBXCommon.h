@@ -35,6 +35,7 @@
 #include <string>
 #include <vector>
 
+#include <SYS/SYS_Math.h>
 #include <SYS/SYS_Types.h>
 #include <UT/UT_StringHolder.h>
 #include <OP/OP_Node.h>
@@ -43,8 +44,12 @@
 
 typedef std::vector  < std::string > TStringVector;
 
+class UT_WorkBuffer;
+
 /********************************************************************************************************/
 static const int ROP_FBX_DUMMY_PARTICLE_GEOM_VERTEX_COUNT = 4;
+/// Default number of distinct warnings an export keeps.
+static const int ROP_FBX_DEFAULT_MAX_MESSAGES = 1000;
 
 static inline bool
 ROPfbxIsLightNodeType(const UT_StringRef &node_type)
@@ -277,6 +282,14 @@ public:
             { return mySopExportPathAttrib; }
     /// @}
 
+    /// If true, the shapes built from the path attribute are extracted
+    /// from the geometry concurrently. The FBX objects are still created
+    /// one at a time on the calling thread.
+    /// @{
+    bool getBuildPathsInParallel() const { return myBuildPathsInParallel; }
+    void setBuildPathsInParallel(bool f) { myBuildPathsInParallel = f; }
+    /// @}
+
     /// The axis system to write into the FBX file
     /// @{
     ROP_FBXAxisSystemType getAxisSystem() const { return myAxisSystem; }
@@ -300,6 +313,117 @@ public:
 
     /// @}
 
+    /// Maximum number of distinct warnings kept by the error manager, or
+    /// zero for no limit. Repeated messages are counted rather than stored
+    /// again.
+    /// @{
+    int getMaxDistinctMessages() const { return myMaxDistinctMessages; }
+    void setMaxDistinctMessages(int max_messages)
+            { myMaxDistinctMessages = max_messages; }
+    /// @}
+
+    /// If set, a Chrome trace (chrome://tracing) of the export phases is
+    /// written to this file when the export finishes.
+    /// @{
+    const UT_StringHolder &getProfileOutputFile() const
+            { return myProfileOutputFile; }
+    void setProfileOutputFile(const UT_StringHolder &file_name)
+            { myProfileOutputFile = file_name; }
+    /// @}
+
+    /// If true, the peak memory and the memory used by each export phase
+    /// are reported as a warning when the export finishes.
+    /// @{
+    bool getReportMemoryUsage() const { return myReportMemoryUsage; }
+    void setReportMemoryUsage(bool f) { myReportMemoryUsage = f; }
+    /// @}
+
+    /// If set, the export statistics are written to this file as JSON
+    /// when the export finishes.
+    /// @{
+    const UT_StringHolder &getStatisticsOutputFile() const
+            { return myStatisticsOutputFile; }
+    void setStatisticsOutputFile(const UT_StringHolder &file_name)
+            { myStatisticsOutputFile = file_name; }
+    /// @}
+
+    /// If true, the export only analyzes the scene and predicts the
+    /// statistics of a real export (ROP_FBXExportStats::myIsEstimate).
+    /// No FBX scene is built and no file is written.
+    /// @{
+    bool getEstimateOnly() const { return myEstimateOnly; }
+    void setEstimateOnly(bool f) { myEstimateOnly = f; }
+    /// @}
+
+    /// Maximum number of threads used by the parallel parts of the export.
+    /// Zero uses all processors, and negative values leave that many
+    /// processors free. One exports single-threaded.
+    /// @{
+    int getNumThreads() const { return myNumThreads; }
+    void setNumThreads(int num_threads) { myNumThreads = num_threads; }
+    /// @}
+
+    /// zlib level of the large arrays of binary files, from 0 (fastest, not
+    /// compressed) to 9 (smallest).
+    /// @{
+    int getCompressionLevel() const { return myCompressionLevel; }
+    void setCompressionLevel(int level) { myCompressionLevel = SYSclamp(level, 0, 9); }
+    /// @}
+
+    /// If true, the file is written and the scene destroyed on a background
+    /// thread (see ROP_FBXBackgroundWriter), and finishing the export does
+    /// not wait for either.
+    /// @{
+    bool getWriteInBackground() const { return myWriteInBackground; }
+    void setWriteInBackground(bool f) { myWriteInBackground = f; }
+    /// @}
+
+    /// If true, the export is skipped when the fingerprint of its inputs
+    /// matches that of the existing file (see ROP_FBXFingerprint).
+    /// @{
+    bool getSkipUnchanged() const { return mySkipUnchanged; }
+    void setSkipUnchanged(bool f) { mySkipUnchanged = f; }
+    /// @}
+
+    /// If true, the file and its vertex caches are written to a local
+    /// temporary directory first, then moved to the output path (see
+    /// ROP_FBXStaging).
+    /// @{
+    bool getStageLocally() const { return myStageLocally; }
+    void setStageLocally(bool f) { myStageLocally = f; }
+    /// @}
+
+    /// If true, the per-frame loops over the exported range (the point
+    /// count scan and the vertex cache writes) record their progress in
+    /// checkpoint files next to the output file, which are removed once
+    /// the export succeeds. The vertex caches of a failed export are kept
+    /// there too, since resuming copies the recorded frames from them.
+    /// See ROP_FBXCheckpoint.
+    /// @{
+    bool getWriteCheckpoints() const { return myWriteCheckpoints; }
+    void setWriteCheckpoints(bool f) { myWriteCheckpoints = f; }
+    /// @}
+
+    /// If true, checkpoints left by a failed export with the same
+    /// fingerprint are resumed rather than started over.
+    /// @{
+    bool getResumeFromCheckpoints() const { return myResumeFromCheckpoints; }
+    void setResumeFromCheckpoints(bool f) { myResumeFromCheckpoints = f; }
+    /// @}
+
+    /// If true, every frame of the range is written to its own file by
+    /// ROP_FBXExporter::writeSequenceFrame(), without animation. The scene
+    /// is only built once for all of them.
+    /// @{
+    bool getExportSequence() const { return myExportSequence; }
+    void setExportSequence(bool f) { myExportSequence = f; }
+    /// @}
+
+    /// Appends the options that affect the written file, for the export
+    /// fingerprint. Options that only affect diagnostics, threading or when
+    /// the file is written are left out.
+    void appendFingerprintText(UT_WorkBuffer& text) const;
+
 private:
 
     /// Resampling frequency, in frames. A linear key frame will be exported
@@ -384,11 +508,51 @@ private:
     UT_Array<ROP_FBXExportClip> myExportClips;
 
     UT_StringHolder mySopExportPathAttrib = "";
+    bool myBuildPathsInParallel = false;
 
     ROP_FBXAxisSystemType myAxisSystem = ROP_FBXAxisSystem_YUp_RightHanded;
     bool myConvertAxisSystem = false;
     int convertUnitTo = 0;
     bool myConvertUnits = false;
+
+    /// Maximum number of distinct warnings kept by the error manager.
+    int myMaxDistinctMessages = ROP_FBX_DEFAULT_MAX_MESSAGES;
+
+    /// If set, a Chrome trace of the export phases is written to this file.
+    UT_StringHolder myProfileOutputFile;
+
+    /// If true, the memory used by each export phase is reported.
+    bool myReportMemoryUsage = false;
+
+    /// If set, the export statistics are written to this file as JSON.
+    UT_StringHolder myStatisticsOutputFile;
+
+    /// If true, the export is only estimated.
+    bool myEstimateOnly = false;
+
+    /// Thread limit of the export, zero for none.
+    int myNumThreads = 0;
+
+    /// zlib level of binary file arrays.
+    int myCompressionLevel = 1;
+
+    /// If true, the file is written on a background thread.
+    bool myWriteInBackground = false;
+
+    /// If true, exports whose inputs have not changed are skipped.
+    bool mySkipUnchanged = false;
+
+    /// If true, files are written locally, then moved into place.
+    bool myStageLocally = false;
+
+    /// If true, long loops write checkpoints.
+    bool myWriteCheckpoints = false;
+
+    /// If true, existing checkpoints are resumed.
+    bool myResumeFromCheckpoints = false;
+
+    /// If true, each frame is written to its own file.
+    bool myExportSequence = false;
 };
 /********************************************************************************************************/
 #endif
@@ -70,6 +70,9 @@ public:
     ROP_FBXActionType getType() override;
     void performAction() override;
 
+    /// Adds the positive weights of one capture region to cluster.
+    static void addSkinWeights(FbxCluster* cluster, GEO_CaptureData& cap_data, int region_idx);
+
 private:
     void createSkinningInfo(
 	    FbxNode* fbx_joint_node, FbxNode* fbx_deformed_node, FbxSkin* fbx_skin,
@@ -33,10 +33,16 @@
 #define __ROP_FBXErrorManager_h__
 
 #include "ROP_FBXCommon.h"
+#include <UT/UT_Lock.h>
 #include <UT/UT_String.h>
 
+#include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
+class UT_WorkBuffer;
+
 /********************************************************************************************************/
 enum ROP_FBXErrorType
 {
@@ -48,19 +54,44 @@ enum ROP_FBXErrorType
 class ROP_FBXError
 {
 public:
-    ROP_FBXError(const char* pMessage, bool bIsCritical, ROP_FBXErrorType eType);
+    ROP_FBXError(const char* pMessage, bool bIsCritical, ROP_FBXErrorType eType, const char* node_name = NULL,
+		 int count = 1);
     virtual ~ROP_FBXError();
 
     bool getIsCritical() const;
     const char* getMessage() const;
     ROP_FBXErrorType getType() const;
+    /// Name of the node the message is about, or an empty string.
+    const char* getNodeName() const;
+
+    /// Number of times this exact message was reported during the export.
+    int getCount() const;
+    void incrementCount(int amount = 1);
+
+    /// Appends the message and its node to the buffer, followed by the
+    /// repeat count when the message was reported more than once.
+    void formatMessage(UT_WorkBuffer& msg_out) const;
 
 private:
     std::string myMessage;
+    std::string myNodeName;
     bool myIsCritical;
     ROP_FBXErrorType myType;
+    int myCount;
 };
 typedef std::vector<ROP_FBXError*> TROPErrorVector;
+/// Messages are told apart by their text, with the severity and type, and
+/// by the node they are about.
+typedef std::pair<std::string, std::string> TROPErrorKey;
+struct ROP_FBXErrorKeyHash
+{
+    size_t operator()(const TROPErrorKey& key) const
+    {
+	std::hash<std::string> hasher;
+	return hasher(key.first) * 31 + hasher(key.second);
+    }
+};
+typedef std::unordered_map<TROPErrorKey, int, ROP_FBXErrorKeyHash> TROPErrorIndexMap;
 /********************************************************************************************************/
 class ROP_FBXErrorManager
 {
@@ -68,23 +99,52 @@ public:
     ROP_FBXErrorManager();
     virtual ~ROP_FBXErrorManager();
 
+    /// Errors may be added from several threads at once.
     void addError(const char* pcsError, bool bIsCritical = false, ROP_FBXErrorType eType = ROP_FBXErrorGeneric);
     void addError(const char* pcsErrorPart1, const char* pcsErrorPart2, const char* pcsErrorPart3, bool bIsCritical = false, ROP_FBXErrorType eType = ROP_FBXErrorGeneric);
+    /// Adds a message about a node. Repeats for the same node are counted
+    /// in one entry, while each node gets an entry of its own.
+    void addNodeError(const char* pcsError, const char* node_name, bool bIsCritical = false, ROP_FBXErrorType eType = ROP_FBXErrorGeneric);
+
+    /// Adds the messages of src, with their repeat counts and the number of
+    /// warnings it suppressed. prefix, if given, is put in front of each
+    /// message.
+    void appendFrom(const ROP_FBXErrorManager& src, const char* prefix = NULL);
 
+    /// The returned error stays valid until reset().
     ROP_FBXError* getError(int err_index);
     int getNumItems() const;
 
     bool getDidReportCriticalErrors() const;
 
+    /// Identical messages are only stored once, with an occurrence count.
+    /// Once this many distinct messages have been stored, any new warnings
+    /// are only counted (critical errors are always kept). A value of zero
+    /// or less means no limit.
+    void setMaxDistinctItems(int max_items);
+    int getMaxDistinctItems() const;
+
+    /// Number of warnings dropped because of the limit above, counting
+    /// every repeat of them.
+    int64 getNumSuppressedItems() const;
+
     void reset();
 
     void appendAllErrors(UT_String& string_out) const;
     void appendAllWarnings(UT_String& string_out) const;
 
 private:
+    void addErrorCount(const char* pcsError, const char* node_name, bool bIsCritical,
+		       ROP_FBXErrorType eType, int count);
 
     TROPErrorVector myErrors;
+    TROPErrorIndexMap myErrorIndices;
+    /// Dropped warnings are only counted, so that a storm of distinct
+    /// warnings costs no memory once the limit is reached.
+    int64 myNumSuppressedItems;
+    int myMaxDistinctItems;
     bool myDidReportCricialErrors;
+    mutable UT_Lock myLock;
 };
 /********************************************************************************************************/
 
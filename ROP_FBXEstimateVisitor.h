@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2024
+ *	Side Effects Software Inc.  All rights reserved.
+ *
+ * Redistribution and use of in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. The name of Side Effects Software may not be used to endorse or
+ *    promote products derived from this software without specific prior
+ *    written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY SIDE EFFECTS SOFTWARE `AS IS' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN
+ * NO EVENT SHALL SIDE EFFECTS SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * NAME:	ROP_FBXEstimateVisitor.h (FBX Library, C++)
+ *
+ * COMMENTS:	Predicts the size and cost of an export without building the scene.
+ *
+ */
+
+#ifndef __ROP_FBXEstimateVisitor_h__
+#define __ROP_FBXEstimateVisitor_h__
+
+#include "ROP_FBXCommon.h"
+#include "ROP_FBXBaseVisitor.h"
+#include "ROP_FBXExportStats.h"
+
+class ROP_FBXExporter;
+class ROP_FBXExportOptions;
+
+class OP_Node;
+class SOP_Node;
+class UT_Interrupt;
+
+/********************************************************************************************************/
+/// Walks the same hierarchy as ROP_FBXMainVisitor and runs the same network
+/// analysis (vertex cache, skin and blend shape detection), but only cooks
+/// a few sample frames of each geometry and creates no FBX objects. The
+/// counts it predicts are combined with per-element costs into an
+/// estimated run time, peak memory and file size.
+class ROP_FBXEstimateVisitor : public ROP_FBXBaseVisitor
+{
+public:
+    ROP_FBXEstimateVisitor(ROP_FBXExporter* parent_exporter);
+    ~ROP_FBXEstimateVisitor() override;
+
+    ROP_FBXBaseNodeVisitInfo* visitBegin(OP_Node* node, int input_idx_on_this_node) override;
+    ROP_FBXVisitorResultType visit(OP_Node* node, ROP_FBXBaseNodeVisitInfo* node_info) override;
+    void onEndHierarchyBranchVisiting(OP_Node* last_node, ROP_FBXBaseNodeVisitInfo* last_node_info) override;
+    const char* getProgressMessage() const override { return "Estimating export"; }
+
+    /// Fills in the predicted counters, sizes and time of stats_out.
+    /// Measured fields (phase times, total time) are left alone.
+    void getEstimate(ROP_FBXExportStats& stats_out) const;
+
+    /// Seconds per element the estimate charges for a kernel of
+    /// ROP_FBXKernelBenchmark, or a negative value for kernels it does not
+    /// use, so that the benchmark can show how far they are from its
+    /// measurements.
+    static fpreal getKernelCost(const char* kernel_name);
+
+private:
+    void estimateGeometry(OP_Node* node);
+    void estimateTransformAnimation(OP_Node* node);
+
+    ROP_FBXExporter* myParentExporter;
+    ROP_FBXExportOptions* myExportOptions;
+    UT_Interrupt* myBoss;
+
+    fpreal myStartTime, myEndTime;
+    exint myNumFrames;
+
+    /// Predicted counts. Only the fields shared with the real statistics
+    /// are kept in myStats.
+    ROP_FBXExportStats myStats;
+    exint myNumVertices;
+    /// Vertices times the layer elements of their mesh.
+    exint myNumLayerValues;
+    exint myNumVertexCachePointFrames;
+    /// Cook time of the sampled frames, scaled to the frames the export
+    /// will cook, in seconds.
+    fpreal myCookTime;
+};
+/********************************************************************************************************/
+#endif // __ROP_FBXEstimateVisitor_h__
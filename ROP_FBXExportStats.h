@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2024
+ *	Side Effects Software Inc.  All rights reserved.
+ *
+ * Redistribution and use of in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. The name of Side Effects Software may not be used to endorse or
+ *    promote products derived from this software without specific prior
+ *    written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY SIDE EFFECTS SOFTWARE `AS IS' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN
+ * NO EVENT SHALL SIDE EFFECTS SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * NAME:	ROP_FBXExportStats.h (FBX Library, C++)
+ *
+ * COMMENTS:	Counters describing the result of an export.
+ *
+ */
+
+#ifndef __ROP_FBXExportStats_h__
+#define __ROP_FBXExportStats_h__
+
+#include <SYS/SYS_Types.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+class UT_InfoTree;
+class UT_WorkBuffer;
+
+typedef std::vector < std::pair < std::string, fpreal > > TPhaseTimeVector;
+/********************************************************************************************************/
+/// What the last export produced. Filled in by the exporter from the final
+/// scene, so that regressions in output size and speed are visible without
+/// opening the file.
+struct ROP_FBXExportStats
+{
+    ROP_FBXExportStats() { reset(); }
+
+    void reset();
+
+    /// Appends one "Label    value" line per counter, in the layout used
+    /// by the node info text.
+    void appendText(UT_WorkBuffer& text_out) const;
+    /// Adds the counters as properties of the given info tree branch.
+    void fillInfoTree(UT_InfoTree& branch) const;
+    /// Writes the counters as a JSON object. Returns false if the file
+    /// could not be written.
+    bool writeJSON(const char* file_name) const;
+
+    exint	 myNumNodes;
+    exint	 myNumMeshes;
+    exint	 myNumPolygons;
+    exint	 myNumControlPoints;
+    exint	 myNumLayerElements;
+    exint	 myNumCurves;
+    exint	 myNumSurfaces;
+    exint	 myNumAnimCurves;
+    exint	 myNumKeys;
+    exint	 myNumMaterials;
+    exint	 myNumTextures;
+    int64	 myVertexCacheBytes;
+    int64	 myEmbeddedBytes;
+    int64	 myOutputBytes;
+    /// Highest resident memory of the process sampled during the export.
+    int64	 myPeakMemory;
+
+    /// Wall-clock time of the whole export and of each profiled phase,
+    /// in seconds.
+    fpreal	 myTotalTime;
+    TPhaseTimeVector myPhaseTimes;
+
+    /// True if the counters and sizes were predicted by an estimate-only
+    /// export rather than counted from a written file. myEstimatedTime is
+    /// then the predicted time of the real export. The byte, memory and
+    /// time predictions come from per-element costs that have not been
+    /// measured, and are reported as uncalibrated.
+    bool	 myIsEstimate;
+    fpreal	 myEstimatedTime;
+};
+/********************************************************************************************************/
+#endif // __ROP_FBXExportStats_h__
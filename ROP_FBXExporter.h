@@ -35,19 +35,43 @@
 #include "ROP_FBXCommon.h"
 
 #include "ROP_FBXErrorManager.h"
+#include "ROP_FBXExportStats.h"
+#include "ROP_FBXGraphMemo.h"
+#include "ROP_FBXParmCache.h"
+#include "ROP_FBXProfiler.h"
+#include "ROP_FBXStaging.h"
 
-#ifdef UT_DEBUG
-#include <UT/UT_Debug.h>
-#endif
+#include <UT/UT_Array.h>
 
 #include <vector>
 #include <string>
 
+class ROP_FBXCheckpoint;
+class ROP_FBXNodeInfo;
 class ROP_FBXNodeManager;
 class ROP_FBXActionManager;
 class UT_Interrupt;
 
 typedef std::vector < char* > TCharPtrVector;
+
+/// An animated property of a sequence export, sampled at every frame of
+/// the range.
+struct ROP_FBXSequenceChannel
+{
+    FbxProperty myProperty;
+    int myNumValues;
+    /// myNumValues values per frame.
+    std::vector<double> myValues;
+};
+
+/// Geometry of a sequence export whose points move, in place of a vertex
+/// cache.
+struct ROP_FBXSequenceGeometry
+{
+    FbxNode* myFbxNode;
+    OP_Node* myNode;
+    ROP_FBXNodeInfo* myNodeInfo;
+};
 /********************************************************************************************************/
 // Note: When adding public members, make sure to add an equivalent to dummy exporter for cases when FBX is
 // disabled.
@@ -64,6 +88,11 @@ enum {
     UNIT_ML  
     
 };
+
+/// Several exporters may exist at once, as with background writes and the
+/// parts of a split export. Building a scene cooks nodes, so doExport()
+/// and writeSequenceFrame() must run on the main thread; only
+/// finishExport() may run on another thread.
 class ROP_FBXExporter
 {
 public:
@@ -75,19 +104,64 @@ public:
     void doExport();
     bool finishExport();
 
+    /// Writes the scene built by doExport() as it is at time t, for
+    /// exports with ROP_FBXExportOptions::getExportSequence(). Only the
+    /// animated properties and the moving points are updated between the
+    /// frames. finishExport() must still be called after the last one.
+    bool writeSequenceFrame(const char* file_name, fpreal t);
+
+    /// Called instead of writing a vertex cache by sequence exports, so
+    /// that writeSequenceFrame() updates the points of fbx_node from node.
+    void addSequenceGeometry(FbxNode* fbx_node, OP_Node* node, ROP_FBXNodeInfo* node_info);
+
     FbxManager* getSDKManager();
     FbxScene* getFBXScene();
     ROP_FBXErrorManager* getErrorManager();
     ROP_FBXNodeManager* getNodeManager();
     ROP_FBXActionManager* getActionManager();
+    ROP_FBXProfiler* getProfiler();
+
+    /// Statistics of the last finished export. Only valid if
+    /// getHasStatistics() returns true.
+    const ROP_FBXExportStats& getStatistics() const { return myStats; }
+    bool getHasStatistics() const { return myHasStats; }
 
     ROP_FBXExportOptions* getExportOptions();
     const char* getOutputFileName();
+    /// Where the files are actually written: the output file itself, or
+    /// its counterpart in the staging directory (see
+    /// ROP_FBXExportOptions::getStageLocally()). Vertex caches are written
+    /// next to it.
+    const char* getWriteFileName();
+
+    /// Opens the checkpoint called name of this export, if checkpoints are
+    /// written. key describes what its records depend on besides the export
+    /// fingerprint. Returns false if the checkpoint is not used.
+    bool openCheckpoint(ROP_FBXCheckpoint& checkpoint, const char* name, const std::string& key,
+			exint record_size);
+
+    /// Opens the cache a failed run of this export left for v_cache, before
+    /// v_cache is opened for writing, so that the frames recorded by its
+    /// checkpoint can be read back instead of cooked. Returns NULL if there
+    /// is none. The cache is removed by closeResumedCache().
+    /// @{
+    FbxCache* openResumedCache(FbxCache* v_cache);
+    void closeResumedCache(FbxCache* resume_cache);
+    /// @}
 
     fpreal getStartTime();
     fpreal getEndTime();
     bool getExportingAnimation();
 
+    /// Time mode and frame rate of the exported scene. Use these for all
+    /// frame to FbxTime conversions instead of FbxTime's global time mode.
+    /// @{
+    FbxTime::EMode getTimeMode() const { return myTimeMode; }
+    fpreal getFrameRate() const { return myFrameRate; }
+    FbxTime getFbxTimeFromFrame(fpreal frame) const;
+    FbxTime getOneFrameTime() const;
+    /// @}
+
     void queueStringToDeallocate(char* string_ptr);
     FbxNode* getFBXRootNode(OP_Node* asking_node, bool create_subnet_root);
     UT_Interrupt* GetBoss();
@@ -95,7 +169,31 @@ public:
     static void getVersions(TStringVector& versions_out);
 
 private:
+    /// The bodies of doExport() and finishExport(), run in a task arena
+    /// limited to ROP_FBXExportOptions::getNumThreads().
+    /// @{
+    void buildScene();
+    bool saveScene();
+    /// @}
+
+    /// Writes the scene to file_name with the FBX SDK.
+    bool writeScene(const char* file_name);
+    /// Samples the animation of the scene for writeSequenceFrame(), then
+    /// removes it from the scene.
+    void prepareSequence();
+    bool saveSequenceFrame(const char* file_name, fpreal t);
+
     void deallocateQueuedStrings();
+    void removeCheckpoints();
+    std::string getCheckpointDirectory() const;
+    /// Where a failed export keeps a vertex cache file for the next run.
+    std::string getKeptCacheFile(const char* cache_file) const;
+    /// Counts what the scene is about to write. Called before the scene
+    /// is handed to the SDK exporter.
+    void gatherSceneStatistics();
+    /// Replaces the scene building part of doExport() for estimate-only
+    /// exports.
+    void estimateExport(OP_Node* start_node);
 
 private:
 
@@ -110,6 +208,8 @@ private:
     std::string myOutputFile;
 
     fpreal myStartTime, myEndTime;
+    FbxTime::EMode myTimeMode;
+    fpreal myFrameRate;
 
     TCharPtrVector myStringsToDeallocate;
     FbxNode* myDummyRootNullNode;
@@ -117,10 +217,30 @@ private:
     UT_Interrupt	*myBoss;
     bool myDidCancel;
 
-#ifdef UT_DEBUG
-    // Timing variables
-    double myDBStartTime, myDBEndTime;
-#endif
+    ROP_FBXProfiler myProfiler;
+    ROP_FBXParmCache myParmCache;
+    ROP_FBXGraphMemo myGraphMemo;
+    ROP_FBXExportStats myStats;
+    bool myHasStats;
+
+    /// Fingerprint of the export's inputs, if getSkipUnchanged() is on.
+    UT_StringHolder myFingerprint;
+    /// True if the file was already up to date and is not written.
+    bool myIsUpToDate;
+
+    ROP_FBXStaging myStaging;
+
+    /// The checkpoint files opened by the export, removed once it succeeds.
+    std::vector<std::string> myCheckpointFiles;
+
+    /// What writeSequenceFrame() updates, and the frames it was sampled at.
+    /// @{
+    std::vector<ROP_FBXSequenceChannel> mySequenceChannels;
+    std::vector<ROP_FBXSequenceGeometry> mySequenceGeometry;
+    fpreal mySequenceStartFrame;
+    int mySequenceNumFrames;
+    int mySequenceNumWritten;
+    /// @}
 };
 /********************************************************************************************************/
 #endif
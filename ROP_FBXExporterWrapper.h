@@ -34,9 +34,30 @@
 
 #include "ROP_FBXCommon.h"
 #include "ROP_FBXErrorManager.h"
+#include "ROP_FBXExportStats.h"
 #include <UT/UT_NonCopyable.h>
+#include <UT/UT_StringArray.h>
+#include <UT/UT_StringHolder.h>
 #include <UT/UT_UniquePtr.h>
 
+#include <vector>
+
+/********************************************************************************************************/
+/// One export of ROP_FBXExporterWrapper::exportBatch().
+struct ROP_FBXExportJob
+{
+    /// Node or @bundle to export. If set, it replaces the start node and
+    /// bundles of myOptions.
+    UT_StringHolder myStartNode;
+    UT_StringHolder myOutputFile;
+    /// Export range, in seconds.
+    fpreal myStartTime = 0;
+    fpreal myEndTime = 0;
+    ROP_FBXExportOptions myOptions;
+};
+typedef std::vector<ROP_FBXExportJob> TExportJobVector;
+typedef std::vector< UT_UniquePtr<ROP_FBXErrorManager> > TErrorManagerVector;
+
 #ifdef FBX_ENABLED
 
 class ROP_FBXExporter;
@@ -59,21 +80,118 @@ public:
     /// @return	True if successful, false on failure.
     bool initializeExport(const char* output_name, fpreal tstart, fpreal tend, ROP_FBXExportOptions* options);
 
+    /// Like initializeExport(), but each of the start nodes is exported to
+    /// the output file of the same index, instead of a single file. The
+    /// bundles and start node of the options are ignored.
+    ///
+    /// doExport() then builds the parts one after another, sharing their
+    /// network analysis, and writes each finished part on a background
+    /// thread while the next one is built. finishExport() waits for the
+    /// writes unless the options write in the background.
+    ///
+    /// Fails with a critical error if two parts would be written to the
+    /// same file.
+    bool initializeSplitExport(const UT_StringArray& start_nodes, const UT_StringArray& output_names,
+			       fpreal tstart, fpreal tend, ROP_FBXExportOptions* options);
+
     /// Performs the actual export process. ROP_FBXExporterWrapper::initializeExport() must be called first.
     void doExport();
 
+    /// Writes the frame at time t to its own file, for exports with
+    /// ROP_FBXExportOptions::getExportSequence(). Must be called after
+    /// doExport(), once for each frame.
+    /// @return	True if the file was written.
+    bool writeSequenceFrame(const char* output_name, fpreal t);
+
     /// This function cleans up after the export is done. It must be called after the 
     /// ROP_FBXExporterWrapper::doExport() function.
+    /// With ROP_FBXExportOptions::getWriteInBackground(), this returns right
+    /// away and the file is written on a background thread, so true only
+    /// means that the write was started. getErrorManager() then has the
+    /// messages of building the scene, while those of the write are
+    /// reported by collectBackgroundWrite() or waitForWrites(), or else by
+    /// the next export of this wrapper or of the same file.
     bool finishExport();
 
+    /// True until the background write of the last export is collected.
+    bool isWritingInBackground() const { return myBackgroundWriteId >= 0; }
+
+    /// Collects the background write of the last export, once it has
+    /// finished or, if wait is set, after waiting for it. Its messages are
+    /// added to errors_out, and its statistics become the ones of
+    /// getStatistics().
+    /// @return	False if the write is still running.
+    bool collectBackgroundWrite(bool wait, ROP_FBXErrorManager& errors_out);
+
+    /// Waits for the background writes of this wrapper and adds their
+    /// messages to getErrorManager().
+    /// @return	False if any of them failed.
+    bool waitForWrites();
+
+    /// Waits for all exports still being written in the background.
+    static void waitForBackgroundWrites();
+
+    /// Exports each job to its own file, and returns once all of them are
+    /// written. The jobs share the analysis of the networks they have in
+    /// common and the pooled FBX SDK managers. Their scenes are built one
+    /// after another, since nodes are cooked on this thread, and written on
+    /// background threads, with at most max_writes writes running at a time
+    /// in the process (zero for ROP_FBXBackgroundWriter::getMaxWrites()).
+    /// Sequences are not supported.
+    /// @param	errors_out	Receives the messages of each job, at the
+    ///				job's index.
+    /// @return	True if all jobs were written without critical errors.
+    static bool exportBatch(const TExportJobVector& jobs, TErrorManagerVector& errors_out,
+			    int max_writes = 0);
+
     /// Retrieves the error manager for this wrapper.
     ROP_FBXErrorManager* getErrorManager();
 
+    /// Copies the statistics of the last finished export into stats_out.
+    /// Split exports have none, since each part is built by an exporter
+    /// of its own and written in the background. Neither does a background
+    /// write until collectBackgroundWrite() has collected it.
+    /// @return	False if no export has finished yet, or if it was split.
+    bool getStatistics(ROP_FBXExportStats& stats_out);
+
     /// Returns true if FBX is supported in the current Houdini build, false otherwise.
     static void getVersions(TStringVector& versions_out);
 
 private:
+    void doSplitExport();
+
+    /// Builds the jobs and starts their writes, see
+    /// ROP_FBXBackgroundWriter::start() for max_writes. The messages of
+    /// building each job go to the error manager of the same index, and
+    /// did_start_out tells which jobs got as far as starting a write. With
+    /// label_writes, the messages of each write start with the job's node,
+    /// like those of doSplitExport() do.
+    static void startJobs(const TExportJobVector& jobs, const std::vector<ROP_FBXErrorManager*>& errors,
+			  int max_writes, const void* owner, bool label_writes,
+			  std::vector<bool>& did_start_out);
+
     UT_UniquePtr<ROP_FBXExporter> myFBXExporter;
+
+    /// The background write of the last export, with the messages of
+    /// building its scene and, once collected, its statistics.
+    /// @{
+    exint myBackgroundWriteId;
+    ROP_FBXErrorManager myBackgroundErrors;
+    bool myUsesBackgroundErrors;
+    ROP_FBXExportStats myWriteStats;
+    bool myHasWriteStats;
+    /// @}
+
+    /// Parts of a split export.
+    /// @{
+    bool myIsSplitExport;
+    UT_StringArray mySplitStartNodes;
+    UT_StringArray mySplitOutputNames;
+    ROP_FBXExportOptions mySplitOptions;
+    fpreal mySplitStartTime;
+    fpreal mySplitEndTime;
+    ROP_FBXErrorManager mySplitErrors;
+    /// @}
 };
 /********************************************************************************************************/
 #else // FBX_ENABLED
@@ -96,16 +214,38 @@ public:
     /// @return	True if successful, false on failure.
     bool initializeExport(const char* output_name, fpreal tstart, fpreal tend, ROP_FBXExportOptions* options) { return false; }
 
+    bool initializeSplitExport(const UT_StringArray& start_nodes, const UT_StringArray& output_names,
+			       fpreal tstart, fpreal tend, ROP_FBXExportOptions* options) { return false; }
+
     /// Performs the actual export process. ROP_FBXExporterWrapper::initializeExport() must be called first.
     void doExport(void) {  }
 
+    bool writeSequenceFrame(const char* /*output_name*/, fpreal /*t*/) { return false; }
+
     /// This function cleans up after the export is done. It must be called after the 
     /// ROP_FBXExporterWrapper::doExport() function.
     bool finishExport(void) { return false; }
 
+    bool isWritingInBackground() const { return false; }
+
+    bool collectBackgroundWrite(bool /*wait*/, ROP_FBXErrorManager& /*errors_out*/) { return true; }
+
+    bool waitForWrites() { return false; }
+
+    static void waitForBackgroundWrites() { }
+
+    static bool exportBatch(const TExportJobVector& /*jobs*/, TErrorManagerVector& /*errors_out*/,
+			    int /*max_writes*/ = 0) { return false; }
+
     /// Retrieves the error manager for this wrapper.
     ROP_FBXErrorManager* getErrorManager(void) { return NULL; }
 
+    /// Copies the statistics of the last finished export into stats_out.
+    /// Split exports have none, since each part is built by an exporter
+    /// of its own and written in the background.
+    /// @return	False if no export has finished yet, or if it was split.
+    bool getStatistics(ROP_FBXExportStats& stats_out) { return false; }
+
     static void getVersions(TStringVector& versions_out) { }
 };
 
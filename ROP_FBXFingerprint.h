@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2024
+ *	Side Effects Software Inc.  All rights reserved.
+ *
+ * Redistribution and use of in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. The name of Side Effects Software may not be used to endorse or
+ *    promote products derived from this software without specific prior
+ *    written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY SIDE EFFECTS SOFTWARE `AS IS' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN
+ * NO EVENT SHALL SIDE EFFECTS SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * NAME:	ROP_FBXFingerprint.h (FBX Library, C++)
+ *
+ * COMMENTS:	Fingerprints of the inputs of an export.
+ *
+ */
+
+#ifndef __ROP_FBXFingerprint_h__
+#define __ROP_FBXFingerprint_h__
+
+#include <UT/UT_Array.h>
+#include <UT/UT_StringArray.h>
+#include <UT/UT_StringHolder.h>
+#include <SYS/SYS_Types.h>
+
+class OP_Node;
+class ROP_FBXExportOptions;
+
+/********************************************************************************************************/
+/// Computes a fingerprint of everything an export's output depends on, so
+/// that an export whose inputs have not changed since the file was last
+/// written can be skipped.
+///
+/// The fingerprint covers the export options, the time range, the nodes
+/// reachable from the exported nodes (their children, inputs and
+/// references), their flags and parameter values over the exported frames,
+/// the geometry stored in locked SOPs, and the size and modification time
+/// of the files those parameters name.
+/// It is a content hash, so it stays valid across sessions.
+///
+/// The fingerprint of the last successful write is recorded in a sidecar
+/// file next to the output, together with the size and modification time
+/// of the file written and of its vertex caches and embedded media folder.
+class ROP_FBXFingerprint
+{
+public:
+    /// Fingerprint of an export of the given nodes to output_file.
+    static UT_StringHolder compute(const UT_Array<OP_Node*>& exported_nodes,
+				   const ROP_FBXExportOptions& options,
+				   const char* output_file, fpreal tstart, fpreal tend);
+
+    /// True if output_file was written by an export with the given
+    /// fingerprint, and neither it nor the files written with it have
+    /// changed or gone since.
+    static bool isUpToDate(const char* output_file, const UT_StringHolder& fingerprint);
+
+    /// Records the fingerprint of output_file, which was just written with
+    /// the given vertex cache files.
+    static bool writeRecord(const char* output_file, const UT_StringHolder& fingerprint,
+			    const UT_StringArray& cache_files);
+
+    /// Forgets the fingerprint of output_file. Called before the file is
+    /// overwritten, so that a failed write is never mistaken as up to date.
+    static void removeRecord(const char* output_file);
+};
+/********************************************************************************************************/
+#endif // __ROP_FBXFingerprint_h__
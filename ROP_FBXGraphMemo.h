@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2024
+ *	Side Effects Software Inc.  All rights reserved.
+ *
+ * Redistribution and use of in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. The name of Side Effects Software may not be used to endorse or
+ *    promote products derived from this software without specific prior
+ *    written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY SIDE EFFECTS SOFTWARE `AS IS' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN
+ * NO EVENT SHALL SIDE EFFECTS SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * NAME:	ROP_FBXGraphMemo.h (FBX Library, C++)
+ *
+ * COMMENTS:	Per-export memo of node network analysis results.
+ *
+ */
+
+#ifndef __ROP_FBXGraphMemo_h__
+#define __ROP_FBXGraphMemo_h__
+
+#include <UT/UT_Map.h>
+#include <UT/UT_NonCopyable.h>
+
+#include <map>
+#include <string>
+
+class OP_Node;
+
+/********************************************************************************************************/
+/// Remembers the answers of ROP_FBXUtil::findTimeDependentNode() and
+/// ROP_FBXUtil::findOpInput() for every node they finish visiting, so that
+/// networks shared by many exported objects (or analyzed by several passes)
+/// are walked and cooked only once per export.
+///
+/// Results are grouped by query: the node types searched for and skipped,
+/// and the evaluation time. The node networks must not change while a memo
+/// is current. Not thread-safe.
+class ROP_FBXGraphMemo
+{
+public:
+    /// The answer for the part of the network upstream of a node.
+    struct Result
+    {
+	/// Node found by findOpInput().
+	OP_Node* myFoundNode;
+	/// findTimeDependentNode() result, or the did_find_allowed_only
+	/// output of findOpInput().
+	bool myFlag;
+    };
+    typedef UT_Map<const OP_Node*, Result> TResultMap;
+
+    ROP_FBXGraphMemo();
+    ~ROP_FBXGraphMemo();
+
+    UT_NON_COPYABLE(ROP_FBXGraphMemo)
+
+    void clear();
+
+    /// The per-node results of a query, created empty the first time.
+    TResultMap& getResults(const std::string& query);
+
+    /// The memo ROP_FBXUtil network queries on the calling thread use.
+    /// Installed by ROP_FBXGraphMemo::Scope.
+    static ROP_FBXGraphMemo* getCurrent();
+
+    /// Makes a memo current on this thread for the lifetime of the object.
+    class Scope
+    {
+    public:
+	Scope(ROP_FBXGraphMemo* memo);
+	~Scope();
+
+	UT_NON_COPYABLE(Scope)
+    private:
+	ROP_FBXGraphMemo* myPrevious;
+    };
+
+private:
+    std::map<std::string, TResultMap> myQueries;
+};
+/********************************************************************************************************/
+#endif // __ROP_FBXGraphMemo_h__
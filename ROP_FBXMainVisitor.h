@@ -35,6 +35,7 @@
 #include "ROP_FBXHeaderWrapper.h"
 #include "ROP_FBXCommon.h"
 #include "ROP_FBXBaseVisitor.h"
+#include "ROP_FBXSceneIR.h"
 
 #include <GA/GA_OffsetList.h>
 #include <UT/UT_Color.h>
@@ -71,18 +72,12 @@ class UT_StringRef;
 class SOP_Node;
 class OP_Node;
 
-/********************************************************************************************************/
-enum ROP_FBXAttributeType
-{
-    ROP_FBXAttributeNormal = 0,
-    ROP_FBXAttributeTangent,
-    ROP_FBXAttributeBinormal,
-    ROP_FBXAttributeUV,
-    ROP_FBXAttributeVertexColor,
-    ROP_FBXAttributeUser,
-
-    ROP_FBXAttributeLastPlaceholder
-};
+/// Blend shape node types, and the node types allowed between a blend shape
+/// node and the exported SOP (ROP_FBXallowed_inbetween_node_types, plus
+/// capture, deform and merge nodes).
+extern const char *const theBlendShapeNodeTypes[];
+extern const char *theAllowedInBetweenNodeTypes[];
+
 /********************************************************************************************************/
 typedef UT_Array < const GA_Attribute* > THDAttributeVector;
 typedef std::map < OP_Node* , FbxSurfaceMaterial* > THdFbxMaterialMap;
@@ -185,10 +180,17 @@ public:
     ROP_FBXBaseNodeVisitInfo* visitBegin(OP_Node* node, int input_idx_on_this_node) override;
     ROP_FBXVisitorResultType visit(OP_Node* node, ROP_FBXBaseNodeVisitInfo* node_info) override;
     void onEndHierarchyBranchVisiting(OP_Node* last_node, ROP_FBXBaseNodeVisitInfo* last_node_info) override;
+    const char* getProgressMessage() const override { return "Building scene"; }
 
     UT_Color getAccumAmbientColor();
     ROP_FBXCreateInstancesAction* getCreateInstancesAction();
 
+    /// Creates an FbxMesh node from an extracted mesh and appends it to
+    /// res_nodes.
+    void outputMesh(const ROP_FBXIRMesh& mesh, const char* node_name, OP_Node* skin_deform_node, int capture_frame, TFbxNodesVector& res_nodes);
+    /// Adds the extracted layer elements and user data to mesh_attr.
+    void exportAttributes(const ROP_FBXIRMesh& mesh, FbxMesh* mesh_attr);
+
 private:
 
     // Given a gdp pointer, this will return a pointer to a gdp which consists of
@@ -200,16 +202,16 @@ private:
     const GU_Detail* getExportableGeo(const GU_Detail* gdp_orig, GU_Detail& conversion_spare,
                                       GA_PrimCompat::TypeMask &prim_types_in_out);
 
-    void setProperName(FbxLayerElement* fbx_layer_elem, const GU_Detail* gdp, const GA_Attribute* attr);
     bool outputGeoNode(OP_Node* node, ROP_FBXMainNodeVisitInfo* node_info, FbxNode* parent_node, ROP_FBXGDPCache* &v_cache_out, bool& did_cancel_out, TFbxNodesVector& res_nodes);
     bool outputShapePrimitives(
-            const UT_Matrix4D& parent_xform,
             SOP_Node* sop_node,
-            const char* node_name,
-            const UT_StringHolder& path_value,
-            const GU_Detail* gdp,
-            const GA_OffsetList& prims,
+            const ROP_FBXIRShape& shape,
             TFbxNodesVector& res_nodes);
+    void finalizeShapeNodes(
+            SOP_Node* sop_node,
+            const ROP_FBXIRShape& shape,
+            TFbxNodesVector& res_nodes,
+            int beg_i);
     bool outputSOPNodeByPath(
             FbxNode* fbx_root,
             const UT_StringRef& path_attrib_name,
@@ -236,16 +238,18 @@ private:
     void outputBezierSurfaces(const GU_Detail* gdp, const char* node_name, OP_Node* skin_deform_node, int capture_frame, TFbxNodesVector& res_nodes, int* prim_cntr = NULL);
     bool outputLODGroupNode(OP_Node* node, ROP_FBXMainNodeVisitInfo* node_info, FbxNode* parent_node, TFbxNodesVector& res_nodes);
 
-    void outputSingleNURBSSurface(const GU_PrimNURBSurf* hd_nurb, const char* curr_name, OP_Node* skin_deform_node, int capture_frame, TFbxNodesVector& res_nodes, int prim_cnt);
+    void outputCurves(const UT_Array<ROP_FBXIRCurve>& curves, OP_Node* skin_deform_node, int capture_frame, TFbxNodesVector& res_nodes);
+    void outputSurfaces(const UT_Array<ROP_FBXIRSurface>& surfaces, OP_Node* skin_deform_node, int capture_frame, TFbxNodesVector& res_nodes);
+    void outputSingleNURBSSurface(const ROP_FBXIRSurface& surface, OP_Node* skin_deform_node, int capture_frame, TFbxNodesVector& res_nodes);
 
     int createTexturesForMaterial(OP_Node* mat_node, FbxSurfaceMaterial* fbx_material, THdFbxTextureMap& tex_map);
 
     void outputPolygons(const GU_Detail* gdp, const char* node_name, int max_points, ROP_FBXVertexCacheMethodType vc_method, OP_Node* skin_deform_node, int capture_frame, TFbxNodesVector& res_nodes);
     void outputNURBSSurface(const GU_Detail* gdp, const char* node_name, OP_Node* skin_deform_node, int capture_frame, TFbxNodesVector& res_nodes);
-    void addUserData(const GU_Detail* gdp, THDAttributeVector& hd_attribs, ROP_FBXAttributeLayerManager& attr_manager, FbxMesh* mesh_attr, FbxLayerElement::EMappingMode mapping_mode );
+    void addUserData(const ROP_FBXIRUserData& user_data, ROP_FBXAttributeLayerManager& attr_manager, FbxMesh* mesh_attr);
 
-    void exportAttributes(const GU_Detail* gdp, FbxMesh* mesh_attr);
     void exportMaterials(OP_Node* source_node, FbxNode* fbx_node, const GU_Detail *mat_gdp = nullptr);
+    void exportMaterials(OP_Node* source_node, FbxNode* fbx_node, const ROP_FBXIRMaterials& materials);
 
     FbxSurfaceMaterial* generateFbxMaterial(OP_Node* mat_node, THdFbxMaterialMap& mat_map);
     FbxSurfaceMaterial* generateFbxMaterial(const char * mat_string, THdFbxStringMaterialMap& mat_map);
@@ -255,14 +259,9 @@ private:
     FbxTexture* generateFbxTexture(OP_Node* mat_node, int texture_idx, UT_StringRef text_parm_name, THdFbxTextureMap& tex_map);
     bool isTexturePresent(OP_Node* mat_node, UT_StringRef text_parm_name, UT_String* texture_path_out);
 
-    ROP_FBXAttributeType getAttrTypeByName(const GU_Detail* gdp, const char* attr_name);
     FbxLayerElement* getAndSetFBXLayerElement(
             FbxLayer* attr_layer,
-            ROP_FBXAttributeType attr_type,
-            const GU_Detail* gdp,
-            const GA_ROAttributeRef& attr_offset,
-            const GA_ROAttributeRef& extra_attr_offset,
-            FbxLayerElement::EMappingMode mapping_mode,
+            const ROP_FBXIRLayerElement& elem,
             FbxLayerContainer* layer_container);
 
     void setFbxNodeVisibility(FbxNode &node, OP_Node *hd_node, bool visible);
@@ -274,9 +273,8 @@ private:
 
     void exportFBXTransform(fpreal t, const OBJ_Node *hd_node, FbxNode* fbx_node);
 
-    void setNURBSSurfaceInfo(FbxNurbsSurface *nurbs_surf_attr, const GU_PrimNURBSurf* hd_nurb);
-    void setNURBSCurveInfo(FbxNurbsCurve* nurbs_curve_attr, const GU_PrimNURBCurve* hd_nurb);
-    void setTrimRegionInfo(GD_TrimRegion* region, FbxTrimNurbsSurface *trim_nurbs_surf_attr, bool& have_fbx_region);
+    void setNURBSSurfaceInfo(FbxNurbsSurface *nurbs_surf_attr, const ROP_FBXIRSurface& surface);
+    void setNURBSCurveInfo(FbxNurbsCurve* nurbs_curve_attr, const ROP_FBXIRCurve& curve);
 
     bool outputBlendShapesNodesIn(OP_Node* node, const UT_String& node_name, OP_Node* skin_deform_node, bool& did_cancel_out, TFbxNodesVector& res_nodes, UT_Set<OP_Node*> *already_visited, ROP_FBXMainNodeVisitInfo* node_info);
     bool outputBlendShapeNode(OP_Node* node, const UT_String& node_name, OP_Node* skin_deform_node, bool& did_cancel_out, TFbxNodesVector& res_nodes, ROP_FBXMainNodeVisitInfo* node_info);
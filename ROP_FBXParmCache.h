@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2024
+ *	Side Effects Software Inc.  All rights reserved.
+ *
+ * Redistribution and use of in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. The name of Side Effects Software may not be used to endorse or
+ *    promote products derived from this software without specific prior
+ *    written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY SIDE EFFECTS SOFTWARE `AS IS' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN
+ * NO EVENT SHALL SIDE EFFECTS SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * NAME:	ROP_FBXParmCache.h (FBX Library, C++)
+ *
+ * COMMENTS:	Cache of parameter indices for repeated lookups by name.
+ *
+ */
+
+#ifndef __ROP_FBXParmCache_h__
+#define __ROP_FBXParmCache_h__
+
+#include <UT/UT_Map.h>
+#include <UT/UT_NonCopyable.h>
+#include <UT/UT_StringMap.h>
+#include <SYS/SYS_Types.h>
+
+class OP_Node;
+class OP_Operator;
+class PRM_Parm;
+
+/********************************************************************************************************/
+/// Remembers where a named parameter lives in the parameter list of each
+/// operator type, so that evaluating the same parameter on many nodes or
+/// over many frames doesn't search the parameter list by name every time.
+///
+/// Entries are keyed by the operator and the text of the parameter name,
+/// and are verified against the parameter token on every hit, since spare
+/// parameters can move the parameters of a single node. Parameters
+/// resolved as properties still work; they just miss the cache.
+///
+/// Not thread-safe. A cache is used by the thread it is current on.
+class ROP_FBXParmCache
+{
+public:
+    ROP_FBXParmCache();
+    ~ROP_FBXParmCache();
+
+    UT_NON_COPYABLE(ROP_FBXParmCache)
+
+    void clear();
+
+    /// Same as OP_Node::getParameterOrProperty(), following channel
+    /// references. Returns NULL if the node has no such parameter.
+    PRM_Parm* findParm(OP_Node* node, const char* parm_name);
+
+    /// The cache ROP_FBXUtil parameter lookups on the calling thread use.
+    /// Installed by ROP_FBXParmCache::Scope.
+    static ROP_FBXParmCache* getCurrent();
+
+    /// Makes a cache current on this thread for the lifetime of the object.
+    class Scope
+    {
+    public:
+	Scope(ROP_FBXParmCache* cache);
+	~Scope();
+
+	UT_NON_COPYABLE(Scope)
+    private:
+	ROP_FBXParmCache* myPrevious;
+    };
+
+private:
+    /// Index in the parameter list by parameter name, for each operator.
+    UT_Map<const OP_Operator*, UT_StringMap<int> > myIndices;
+};
+/********************************************************************************************************/
+#endif // __ROP_FBXParmCache_h__
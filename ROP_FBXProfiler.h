@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) 2024
+ *	Side Effects Software Inc.  All rights reserved.
+ *
+ * Redistribution and use of in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. The name of Side Effects Software may not be used to endorse or
+ *    promote products derived from this software without specific prior
+ *    written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY SIDE EFFECTS SOFTWARE `AS IS' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN
+ * NO EVENT SHALL SIDE EFFECTS SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * NAME:	ROP_FBXProfiler.h (FBX Library, C++)
+ *
+ * COMMENTS:	Scoped wall-clock and memory profiling of the export phases.
+ *
+ */
+
+#ifndef __ROP_FBXProfiler_h__
+#define __ROP_FBXProfiler_h__
+
+#include <SYS/SYS_Types.h>
+#include <UT/UT_Lock.h>
+#include <UT/UT_NonCopyable.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+/********************************************************************************************************/
+/// A single timed scope, in microseconds since the profiler was reset.
+struct ROP_FBXProfileEvent
+{
+    std::string myName;
+    std::string myDetail;
+    int64 myStart;
+    int64 myDuration;
+    int myThread;
+};
+typedef std::vector<ROP_FBXProfileEvent> TProfileEventVector;
+
+/// A resident memory sample, in bytes, taken at a time in microseconds.
+struct ROP_FBXMemorySample
+{
+    int64 myTime;
+    int64 myMemory;
+};
+typedef std::vector<ROP_FBXMemorySample> TMemorySampleVector;
+
+/// Accumulated time and memory for all scopes sharing the same name.
+struct ROP_FBXProfilePhase
+{
+    int64 myTotalTime = 0;
+    int64 myCount = 0;
+    /// Sum of the resident memory growth over all scopes of this phase.
+    int64 myMemoryDelta = 0;
+    /// Highest resident memory seen when a scope of this phase ended.
+    int64 myPeakMemory = 0;
+};
+typedef std::map<std::string, ROP_FBXProfilePhase> TProfilePhaseMap;
+
+/// Memory held by one of the exporter's own caches.
+struct ROP_FBXTrackedMemory
+{
+    int64 myCurrent = 0;
+    int64 myPeak = 0;
+};
+typedef std::map<std::string, ROP_FBXTrackedMemory> TTrackedMemoryMap;
+/********************************************************************************************************/
+/// Collects wall-clock timings and resident memory for the export phases.
+/// Per-phase totals are always accumulated; individual events are only kept
+/// when requested (for the Chrome trace output), since a long vertex cache
+/// export can produce one cook scope per node per frame.
+class ROP_FBXProfiler
+{
+public:
+    ROP_FBXProfiler();
+    ~ROP_FBXProfiler();
+
+    UT_NON_COPYABLE(ROP_FBXProfiler)
+
+    /// Clears all timings and restarts the clock.
+    void reset();
+
+    /// If true, every scope is recorded individually for writeChromeTrace().
+    void setRecordEvents(bool value);
+    bool getRecordEvents() const;
+
+    /// Microseconds elapsed since the last reset().
+    int64 getElapsedTime() const;
+
+    void addEvent(const char* name, const char* detail, int64 start, int64 duration,
+		  int64 memory_delta = 0, int64 end_memory = 0);
+
+    /// Per-phase totals, keyed by scope name.
+    void getPhases(TProfilePhaseMap& phases_out) const;
+    /// Total time spent in the named phase, in seconds.
+    fpreal getPhaseTime(const char* name) const;
+
+    /// Writes the recorded events in the Chrome trace event JSON format
+    /// (chrome://tracing, Perfetto). Returns false if the file could not be
+    /// written.
+    bool writeChromeTrace(const char* file_name) const;
+
+    /// Prints the per-phase totals to stdout.
+    void printSummary() const;
+
+    /// Samples the resident memory of the process and updates the peak.
+    /// Cheap enough to be called from inside long loops, since the OS is
+    /// only queried every few milliseconds unless force is set. Returns the
+    /// latest sample, in bytes.
+    int64 sampleMemory(bool force = false);
+    /// Resident memory when the profiler was reset, in bytes.
+    int64 getStartMemory() const;
+    /// Highest resident memory sampled since the profiler was reset.
+    int64 getPeakMemory() const;
+
+    /// Accounts for memory held by the exporter's own caches (e.g. the
+    /// vertex cache frame geometry), which resident memory alone can't
+    /// attribute.
+    void adjustTrackedMemory(const char* name, int64 delta);
+    void getTrackedMemory(TTrackedMemoryMap& tracked_out) const;
+
+    /// Appends a human readable report of the peak memory, the per-phase
+    /// deltas and the tracked caches.
+    void appendMemoryReport(std::string& report_out) const;
+
+    /// Current and peak resident set size of the process, in bytes. The
+    /// peak is the operating system's value for the process lifetime.
+    static int64 getResidentMemory();
+    static int64 getPeakResidentMemory();
+
+    /// The profiler scopes on the calling thread report to. Installed by
+    /// ROP_FBXProfiler::Scope, so that static helpers (ROP_FBXUtil) can be
+    /// timed without passing the exporter around.
+    static ROP_FBXProfiler* getCurrent();
+
+    /// Makes a profiler current on this thread for the lifetime of the object.
+    class Scope
+    {
+    public:
+	Scope(ROP_FBXProfiler* profiler);
+	~Scope();
+
+	UT_NON_COPYABLE(Scope)
+    private:
+	ROP_FBXProfiler* myPrevious;
+    };
+
+private:
+    int64 myOrigin;
+    bool myRecordEvents;
+    int64 myNumDroppedEvents;
+
+    mutable UT_Lock myLock;
+    TProfileEventVector myEvents;
+    TProfilePhaseMap myPhases;
+
+    int64 myStartMemory;
+    int64 myPeakMemory;
+    int64 myLastMemory;
+    int64 myLastMemoryTime;
+    TMemorySampleVector myMemorySamples;
+    TTrackedMemoryMap myTrackedMemory;
+};
+/********************************************************************************************************/
+/// Times the enclosing block and reports it to the current profiler, if any.
+/// The name should be a phase name ("Cook", "Mesh Build", ...) and the
+/// optional detail usually the node being processed.
+class ROP_FBXProfileScope
+{
+public:
+    ROP_FBXProfileScope(const char* name, const char* detail = nullptr);
+    ~ROP_FBXProfileScope();
+
+    UT_NON_COPYABLE(ROP_FBXProfileScope)
+private:
+    ROP_FBXProfiler* myProfiler;
+    const char* myName;
+    const char* myDetail;
+    int64 myStart;
+    int64 myStartMemory;
+};
+/********************************************************************************************************/
+#endif // __ROP_FBXProfiler_h__
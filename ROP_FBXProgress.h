@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2024
+ *	Side Effects Software Inc.  All rights reserved.
+ *
+ * Redistribution and use of in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. The name of Side Effects Software may not be used to endorse or
+ *    promote products derived from this software without specific prior
+ *    written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY SIDE EFFECTS SOFTWARE `AS IS' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN
+ * NO EVENT SHALL SIDE EFFECTS SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * NAME:	ROP_FBXProgress.h (FBX Library, C++)
+ *
+ * COMMENTS:	Progress reporting and interruption inside long export loops.
+ *
+ */
+
+#ifndef __ROP_FBXProgress_h__
+#define __ROP_FBXProgress_h__
+
+#include <UT/UT_NonCopyable.h>
+#include <UT/UT_UniquePtr.h>
+#include <SYS/SYS_Types.h>
+
+class UT_AutoInterrupt;
+
+/********************************************************************************************************/
+/// Shows the progress of one phase of the export, and lets the user
+/// interrupt it. The interrupt is only polled every poll_interval steps, so
+/// step() is cheap enough to call for every element of the phase.
+///
+/// On the main thread this opens a nested interrupt scope with its own
+/// message and percentage. On other threads it only polls the interrupt
+/// raised on the main thread. Opening a scope is not free, so loops inside
+/// a phase use ROP_FBXProgressLoop instead.
+///
+/// While it exists, the progress is the current one of the thread that
+/// created it.
+class ROP_FBXProgress
+{
+public:
+    ROP_FBXProgress(const char* message, exint num_steps, exint poll_interval = 1);
+    ~ROP_FBXProgress();
+
+    UT_NON_COPYABLE(ROP_FBXProgress)
+
+    /// Reports that step_idx of the steps are done. Returns false if the
+    /// export was interrupted, after which the loop should stop.
+    bool step(exint step_idx)
+    {
+	if(myWasInterrupted)
+	    return false;
+	if(step_idx < myNextPoll)
+	    return true;
+	return poll(step_idx);
+    }
+
+    /// Like step(), but always polls the interrupt.
+    bool poll(exint step_idx);
+
+    /// Polls the interrupt without advancing the percentage.
+    bool pollInterrupt();
+
+    bool wasInterrupted() const { return myWasInterrupted; }
+
+    /// The innermost progress of the calling thread, or NULL.
+    static ROP_FBXProgress* getCurrent();
+
+    /// While set, progress created on the calling thread never polls the
+    /// interrupt. Used by background writes, which outlive the cook that
+    /// started them.
+    static void setThreadIgnoresInterrupts(bool ignore);
+
+private:
+
+    UT_UniquePtr<UT_AutoInterrupt> myInterrupt;
+    ROP_FBXProgress* myPrevProgress;
+    exint myNumSteps;
+    exint myPollInterval;
+    exint myNextPoll;
+    int myPercent;
+    bool myWasInterrupted;
+};
+/********************************************************************************************************/
+/// Lets the user interrupt a loop inside a phase of the export, such as
+/// the polygons of one mesh or the samples of one animation. It polls the
+/// current ROP_FBXProgress every poll_interval steps, without opening a
+/// scope of its own, so it is cheap to create for every mesh or node.
+class ROP_FBXProgressLoop
+{
+public:
+    explicit ROP_FBXProgressLoop(exint poll_interval = 1);
+
+    UT_NON_COPYABLE(ROP_FBXProgressLoop)
+
+    /// Reports that step_idx of the steps are done. Returns false if the
+    /// export was interrupted, after which the loop should stop.
+    bool step(exint step_idx)
+    {
+	if(myWasInterrupted)
+	    return false;
+	if(step_idx < myNextPoll)
+	    return true;
+	return poll(step_idx);
+    }
+
+    /// Like step(), but always polls the interrupt.
+    bool poll(exint step_idx);
+
+    bool wasInterrupted() const { return myWasInterrupted; }
+
+private:
+    exint myPollInterval;
+    exint myNextPoll;
+    bool myWasInterrupted;
+};
+/********************************************************************************************************/
+#endif // __ROP_FBXProgress_h__
@@ -0,0 +1,315 @@
+/*
+ * Copyright (c) 2024
+ *	Side Effects Software Inc.  All rights reserved.
+ *
+ * Redistribution and use of in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. The name of Side Effects Software may not be used to endorse or
+ *    promote products derived from this software without specific prior
+ *    written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY SIDE EFFECTS SOFTWARE `AS IS' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN
+ * NO EVENT SHALL SIDE EFFECTS SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * NAME:	ROP_FBXSceneIR.h (FBX Library, C++)
+ *
+ * COMMENTS:	The geometry, materials and node tree of an export, extracted
+ *		from Houdini into plain arrays independently of the FBX SDK,
+ *		so that extraction can run on any thread and only the FBX
+ *		objects are created on the main thread.
+ *
+ */
+
+#ifndef __ROP_FBXSceneIR_h__
+#define __ROP_FBXSceneIR_h__
+
+#include <GA/GA_OffsetList.h>
+#include <GA/GA_PrimCompat.h>
+#include <UT/UT_Array.h>
+#include <UT/UT_Matrix4.h>
+#include <UT/UT_NonCopyable.h>
+#include <UT/UT_StringArray.h>
+#include <UT/UT_StringHolder.h>
+#include <UT/UT_UniquePtr.h>
+#include <UT/UT_Vector3.h>
+#include <UT/UT_Vector4.h>
+
+class GA_ROHandleS;
+class GEO_CaptureData;
+class GU_Detail;
+class UT_WorkBuffer;
+
+/********************************************************************************************************/
+enum ROP_FBXAttributeType
+{
+    ROP_FBXAttributeNormal = 0,
+    ROP_FBXAttributeTangent,
+    ROP_FBXAttributeBinormal,
+    ROP_FBXAttributeUV,
+    ROP_FBXAttributeVertexColor,
+    ROP_FBXAttributeUser,
+
+    ROP_FBXAttributeLastPlaceholder
+};
+/// How the values of a layer element map onto a mesh. These are the FBX
+/// eByControlPoint, eByPolygonVertex, eByPolygon and eAllSame modes.
+enum ROP_FBXIRMappingType
+{
+    ROP_FBXIRMappingPoint = 0,
+    ROP_FBXIRMappingVertex,
+    ROP_FBXIRMappingPrimitive,
+    ROP_FBXIRMappingDetail
+};
+/// The FBX eOpen, eClosed and ePeriodic NURBS types.
+enum ROP_FBXIRCurveType
+{
+    ROP_FBXIRCurveOpen = 0,
+    ROP_FBXIRCurveClosed,
+    ROP_FBXIRCurvePeriodic
+};
+/********************************************************************************************************/
+/// A normal, tangent, binormal, UV or colour layer element of a mesh.
+/// Vectors use xyz, UVs xy and colours rgba.
+struct ROP_FBXIRLayerElement
+{
+    ROP_FBXAttributeType myType;
+    ROP_FBXIRMappingType myMapping;
+    UT_StringHolder myName;
+    /// When indexed, myIndices has an index into myValues per element.
+    /// Otherwise myValues has the value of every element.
+    bool myIsIndexed;
+    UT_Array<UT_Vector4D> myValues;
+    UT_IntArray myIndices;
+};
+/// One component of a user attribute.
+struct ROP_FBXIRUserChannel
+{
+    UT_StringHolder myName;
+    bool myIsInt;
+    UT_Array<int> myInts;
+    UT_Array<float> myFloats;
+};
+/// The user attributes of one attribute class, which become one FBX user
+/// data layer element.
+struct ROP_FBXIRUserData
+{
+    ROP_FBXIRMappingType myMapping;
+    UT_Array<ROP_FBXIRUserChannel> myChannels;
+};
+/// A polygon mesh. The layer elements and user data are in the order of
+/// their attribute classes: point, vertex, primitive, then detail.
+struct ROP_FBXIRMesh
+{
+    UT_Array<UT_Vector4D> myControlPoints;
+    /// The vertex count of every polygon, and the control point of each of
+    /// their vertices in FBX winding order.
+    UT_IntArray myPolygonSizes;
+    UT_IntArray myPolygonVertices;
+    UT_Array<ROP_FBXIRLayerElement> myLayerElements;
+    UT_Array<ROP_FBXIRUserData> myUserData;
+};
+/// A NURBS curve. A curve without control points is written empty.
+struct ROP_FBXIRCurve
+{
+    ROP_FBXIRCurve();
+
+    UT_StringHolder myName;
+    int myOrder;
+    ROP_FBXIRCurveType myType;
+    UT_Array<fpreal64> myKnots;
+    UT_Array<UT_Vector4D> myControlPoints;
+    /// The index of the source primitive among the ones the export counts,
+    /// or -1.
+    int myPrimIndex;
+};
+/// A trim loop of a surface. Counterclockwise loops begin a new trim
+/// region.
+struct ROP_FBXIRTrimBoundary
+{
+    bool myBeginsRegion;
+    UT_Array<ROP_FBXIRCurve> myCurves;
+};
+/// A NURBS surface, with its trim loops if it has any.
+struct ROP_FBXIRSurface
+{
+    ROP_FBXIRSurface();
+
+    UT_StringHolder myName;
+    int myUOrder;
+    int myVOrder;
+    ROP_FBXIRCurveType myUType;
+    ROP_FBXIRCurveType myVType;
+    int myNumCols;
+    int myNumRows;
+    UT_Array<fpreal64> myUKnots;
+    UT_Array<fpreal64> myVKnots;
+    /// Row by row.
+    UT_Array<UT_Vector4D> myControlPoints;
+    int myPrimIndex;
+    bool myIsTrimmed;
+    UT_Array<ROP_FBXIRTrimBoundary> myBoundaries;
+};
+/// The material paths of the primitives of a detail. Only the paths are
+/// extracted; the material nodes are found when they are written.
+struct ROP_FBXIRMaterials
+{
+    ROP_FBXIRMaterials() : myHasPrimMaterials(false) { }
+
+    /// False if the detail has no material attribute.
+    bool myHasPrimMaterials;
+    UT_StringArray myPaths;
+    /// An index into myPaths per primitive, or -1 if it has no material.
+    UT_IntArray myPrimPaths;
+};
+/// The weights of the points a capture region influences.
+struct ROP_FBXIRSkinCluster
+{
+    UT_IntArray myPointIndices;
+    UT_Array<fpreal64> myWeights;
+};
+/********************************************************************************************************/
+/// An FbxNode of a path attribute export. The first nodes are those of the
+/// shapes; the rest are the nulls (or LOD groups) above them that no shape
+/// defines.
+struct ROP_FBXIRNode
+{
+    UT_StringHolder myName;
+    /// Index of the parent node, or -1 for a top-level node.
+    exint myParent;
+    /// Index of the shape, or -1 for a null.
+    exint myShape;
+    bool myIsLODGroup;
+};
+/// The part of a SOP that becomes one FbxNode when exporting by path
+/// attribute, and the geometry extracted for it.
+struct ROP_FBXIRShape
+{
+    ROP_FBXIRShape();
+
+    UT_StringHolder myPathValue;
+    UT_StringHolder myFBXPath;
+    const char* myNodeName;
+    GA_OffsetList myPrims;
+
+    /// @{
+    /// Filled in by ROP_FBXSceneIR::extractShape(). The geometry is
+    /// unpacked and relative to the transform, which is already split into
+    /// its components. A pure polygon shape has a mesh and its polylines
+    /// as curves; other shapes have their surfaces and curves.
+    bool myHasMesh;
+    ROP_FBXIRMesh myMesh;
+    UT_Array<ROP_FBXIRSurface> mySurfaces;
+    UT_Array<ROP_FBXIRCurve> myCurves;
+    ROP_FBXIRMaterials myMaterials;
+    UT_Vector3D myTranslate;
+    UT_Vector3D myRotate;
+    UT_Vector3D myScale;
+    UT_Vector3D myOrigin;
+    bool myHasXform;
+    bool myIsExtracted;
+    /// @}
+};
+
+/********************************************************************************************************/
+/// Separates reading the Houdini geometry of an export from building the
+/// FBX objects for it. A scene IR holds the shapes and node tree of a SOP
+/// exported by path attribute. The static extract functions are also used
+/// by the visitor for the other objects, and by the kernel benchmark.
+///
+/// Extraction only reads the source detail (or a private copy of it) and
+/// writes into the arrays it is given, so it is safe to run concurrently.
+class ROP_FBXSceneIR
+{
+public:
+    ROP_FBXSceneIR(bool convert_surfaces, float poly_lod);
+    ~ROP_FBXSceneIR();
+
+    UT_NON_COPYABLE(ROP_FBXSceneIR)
+
+    /// Groups the primitives of gdp into shapes by the value of path_attrib,
+    /// in order of first appearance, and builds the node tree over them.
+    /// Returns false and fills in error_out if a path has no node name.
+    bool partition(const GU_Detail& gdp, const GA_ROHandleS& path_attrib,
+		   UT_WorkBuffer& error_out);
+
+    exint getNumShapes() const { return myShapes.size(); }
+    ROP_FBXIRShape& getShape(exint i) { return *myShapes(i); }
+    const ROP_FBXIRShape& getShape(exint i) const { return *myShapes(i); }
+
+    /// Node i is the node of shape i, for every shape.
+    exint getNumNodes() const { return myNodes.size(); }
+    const ROP_FBXIRNode& getNode(exint i) const { return myNodes(i); }
+
+    /// Extracts the geometry of one shape from gdp, the detail it was
+    /// partitioned from. Returns false if unpacking failed or the export
+    /// was interrupted.
+    bool extractShape(exint i, const GU_Detail& gdp, const UT_Matrix4D& parent_xform);
+    /// Extracts all the shapes concurrently.
+    void extractShapes(const GU_Detail& gdp, const UT_Matrix4D& parent_xform);
+    /// Frees the geometry of a shape once it has been translated.
+    void releaseShape(exint i);
+
+    /// Returns gdp_orig, or a copy of it in conversion_spare with the
+    /// primitive types not natively exported converted to polygons and the
+    /// bone capture attribute removed.
+    static const GU_Detail* getExportableGeo(
+	    const GU_Detail* gdp_orig,
+	    GU_Detail& conversion_spare,
+	    GA_PrimCompat::TypeMask &prim_types_in_out,
+	    bool convert_surfaces,
+	    float poly_lod);
+
+    /// Extracts the meshes and closed polygons of gdp, and its attributes.
+    /// The control points are padded with zeros up to max_points, and when
+    /// points_per_poly is positive, the padding is covered by dummy
+    /// polygons of that many vertices. Returns false if interrupted.
+    static bool extractMesh(const GU_Detail& gdp, int max_points, int points_per_poly,
+			    ROP_FBXIRMesh& mesh_out);
+    /// Extracts the layer elements and user data of a mesh.
+    static void extractAttributes(const GU_Detail& gdp, ROP_FBXIRMesh& mesh_out);
+
+    /// @{
+    /// Append a curve or surface per primitive of one type, named after
+    /// node_name. prim_cntr counts the primitives across calls.
+    static void extractPolylines(const GU_Detail& gdp, const char* node_name,
+				 UT_Array<ROP_FBXIRCurve>& curves_out);
+    static void extractNURBSCurves(const GU_Detail& gdp, const char* node_name,
+				   UT_Array<ROP_FBXIRCurve>& curves_out, int* prim_cntr = nullptr);
+    static void extractBezierCurves(const GU_Detail& gdp, const char* node_name,
+				    UT_Array<ROP_FBXIRCurve>& curves_out, int* prim_cntr = nullptr);
+    static void extractNURBSSurfaces(const GU_Detail& gdp, const char* node_name,
+				     UT_Array<ROP_FBXIRSurface>& surfaces_out, int* prim_cntr = nullptr);
+    static void extractBezierSurfaces(const GU_Detail& gdp, const char* node_name,
+				      UT_Array<ROP_FBXIRSurface>& surfaces_out, int* prim_cntr = nullptr);
+    /// @}
+
+    /// Extracts the material path of every primitive of gdp.
+    static void extractMaterials(const GU_Detail& gdp, ROP_FBXIRMaterials& materials_out);
+    /// Extracts the positive weights of one capture region.
+    static void extractSkinWeights(GEO_CaptureData& cap_data, int region_idx,
+				   ROP_FBXIRSkinCluster& cluster_out);
+
+    /// The layer element type of an attribute, by its name without any
+    /// numerical suffix.
+    static ROP_FBXAttributeType getAttrTypeByName(const char* attr_name);
+
+private:
+    UT_Array<UT_UniquePtr<ROP_FBXIRShape> > myShapes;
+    UT_Array<ROP_FBXIRNode> myNodes;
+    bool myConvertSurfaces;
+    float myPolyLOD;
+};
+/********************************************************************************************************/
+#endif // __ROP_FBXSceneIR_h__
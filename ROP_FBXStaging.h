@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2024
+ *	Side Effects Software Inc.  All rights reserved.
+ *
+ * Redistribution and use of in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. The name of Side Effects Software may not be used to endorse or
+ *    promote products derived from this software without specific prior
+ *    written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY SIDE EFFECTS SOFTWARE `AS IS' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN
+ * NO EVENT SHALL SIDE EFFECTS SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * NAME:	ROP_FBXStaging.h (FBX Library, C++)
+ *
+ * COMMENTS:	Local staging of exported files.
+ *
+ */
+
+#ifndef __ROP_FBXStaging_h__
+#define __ROP_FBXStaging_h__
+
+#include <UT/UT_NonCopyable.h>
+#include <UT/UT_StringArray.h>
+
+#include <string>
+
+class UT_WorkBuffer;
+
+/********************************************************************************************************/
+/// A local temporary directory an export writes its files to before they
+/// are moved to the output path. Small scattered writes then go to a local
+/// disk, and the output path only ever sees whole files: each file is
+/// copied next to its destination with large sequential writes and renamed
+/// over it, which is atomic on the destination's file system.
+///
+/// Staged files keep their paths relative to the FBX file, so the
+/// relative vertex cache paths written into it stay valid.
+class ROP_FBXStaging
+{
+public:
+    ROP_FBXStaging();
+    /// Removes the staging directory and whatever is still in it.
+    ~ROP_FBXStaging();
+
+    UT_NON_COPYABLE(ROP_FBXStaging)
+
+    /// Creates an empty staging directory for final_file in the temporary
+    /// directory of the session. Returns false if it cannot be created.
+    bool create(const char* final_file);
+
+    bool isActive() const { return myDirectory.length() > 0; }
+
+    /// Where the FBX file is written instead of the final file.
+    const char* getStagedFile() const { return myStagedFile.c_str(); }
+
+    /// Where a file of the staging directory ends up once published.
+    /// Returns staged_path itself if it is not in the staging directory.
+    std::string getFinalPath(const char* staged_path) const;
+
+    /// Moves the given staged files, then the FBX file itself, to their
+    /// final paths. The FBX file is moved last, so it never appears before
+    /// its caches.
+    bool publish(const UT_StringArray& staged_files, UT_WorkBuffer& error);
+
+    /// Removes the staged files and the staging directory.
+    void discard(const UT_StringArray& staged_files);
+
+    /// Moves a file over another one, copying it if they are on different
+    /// file systems.
+    static bool moveFile(const char* source, const char* destination);
+
+private:
+    std::string myDirectory;
+    std::string myFinalDirectory;
+    std::string myStagedFile;
+    std::string myFinalFile;
+};
+/********************************************************************************************************/
+#endif // __ROP_FBXStaging_h__
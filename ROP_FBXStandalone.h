@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2024
+ *	Side Effects Software Inc.  All rights reserved.
+ *
+ * Redistribution and use of in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. The name of Side Effects Software may not be used to endorse or
+ *    promote products derived from this software without specific prior
+ *    written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY SIDE EFFECTS SOFTWARE `AS IS' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN
+ * NO EVENT SHALL SIDE EFFECTS SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * NAME:	ROP_FBXStandalone.h (FBX Library, C++)
+ *
+ * COMMENTS:	Helpers for running the exporter outside of a Houdini session.
+ *
+ */
+
+#ifndef __ROP_FBXStandalone_h__
+#define __ROP_FBXStandalone_h__
+
+#include "ROP_FBXCommon.h"
+#include "ROP_FBXExportStats.h"
+
+class OP_Node;
+class UT_WorkBuffer;
+/********************************************************************************************************/
+/// Sets up the HDK for command line programs (benchmarks, batch tools) that
+/// build or load a scene and export it through ROP_FBXExporterWrapper,
+/// without going through a ROP node.
+class ROP_FBXStandalone
+{
+public:
+    /// Creates the director and the resource manager. Must be called once
+    /// before any other function here. Safe to call again.
+    static void initialize();
+
+    /// Loads a .hip file, replacing the current session.
+    static bool loadHipFile(const char* hip_file, UT_WorkBuffer& errors_out);
+
+    /// Creates a node of the given type inside the network at parent_path.
+    /// Returns NULL if the parent or the type does not exist.
+    static OP_Node* createNode(const char* parent_path, const char* type, const char* name);
+    static OP_Node* createNode(OP_Node* parent, const char* type, const char* name);
+
+    /// Parameter setters that quietly ignore parameters the node type does
+    /// not have, since parameter names drift between Houdini versions.
+    /// @{
+    static bool setParm(OP_Node* node, const char* parm_name, fpreal value, int index = 0);
+    static bool setParm(OP_Node* node, const char* parm_name, const char* value, int index = 0);
+    static bool setParmExpression(OP_Node* node, const char* parm_name, const char* expression, int index = 0);
+    /// @}
+
+    /// Seconds at the start of the given frame.
+    static fpreal getFrameTime(fpreal frame);
+
+    /// Parses the whole of text as a number, the way setOption() parses
+    /// numeric options.
+    /// @return	False if text is empty or has anything after the number.
+    static bool parseNumber(const char* text, fpreal& value_out);
+
+    /// Sets the export option with the same name as the FBX ROP parameter
+    /// controlling it, parsing value as the parameter's type. Menus take
+    /// the index of their item.
+    /// @return	False, with a message in errors_out, if the name is unknown
+    ///		or the value does not parse.
+    static bool setOption(ROP_FBXExportOptions& options, const char* name, const char* value,
+			  UT_WorkBuffer& errors_out);
+
+    /// Appends a line with the name and description of each option known
+    /// to setOption().
+    static void appendOptionsHelp(UT_WorkBuffer& text_out);
+
+    /// Runs a complete export of the frame range. output_file is expanded
+    /// at the start frame, or at each frame for exports with
+    /// ROP_FBXExportOptions::getExportSequence(). All exporter messages are
+    /// appended to messages_out, one per line. If stats_out is given, it
+    /// receives the export statistics.
+    /// @return	True if the files were written without critical errors.
+    static bool exportScene(const char* output_file, fpreal start_frame, fpreal end_frame,
+			    const ROP_FBXExportOptions& options, UT_WorkBuffer& messages_out,
+			    ROP_FBXExportStats* stats_out = NULL);
+};
+/********************************************************************************************************/
+#endif // __ROP_FBXStandalone_h__
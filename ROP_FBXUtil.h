@@ -50,8 +50,10 @@
 #include <string>
 
 
+class ROP_FBXCheckpoint;
 class ROP_FBXGDPCache;
 class ROP_FBXMainNodeVisitInfo;
+class ROP_FBXProfiler;
 
 class OBJ_Node;
 class SOP_Node;
@@ -77,9 +79,11 @@ public:
     static int getIntOPParm(OP_Node *node, const char* parmName, fpreal ftime, int index = 0);
     static fpreal getFloatOPParm(OP_Node *node, const char* parmName, fpreal ftime, int index = 0, bool *did_find = NULL);
 
+    /// If a checkpoint is given, the frames it already has are not cooked
+    /// again, and the new ones are recorded in it.
     static int getMaxPointsOverAnimation(OP_Node* op_node, fpreal start_time, fpreal end_time, float lod,
             bool allow_constant_point_detection, bool convert_surfaces, UT_Interrupt* boss_op,
-            ROP_FBXGDPCache* v_cache_out, bool &is_pure_surfaces);
+            ROP_FBXGDPCache* v_cache_out, bool &is_pure_surfaces, ROP_FBXCheckpoint* checkpoint = nullptr);
     static bool isVertexCacheable(OP_Network *op_net, bool include_deform_nodes, fpreal ftime, bool& found_particles, bool is_sop_export);
 
     static void convertParticleGDPtoPolyGDP(const GU_Detail* src_gdp, GU_Detail& out_gdp);
@@ -95,7 +99,7 @@ public:
     static bool getPostRotateAdjust(const UT_StringRef &node_type, FbxVector4 &post_rotate);
     static void doPostRotateAdjust(FbxVector4 &post_rotate, const FbxVector4 &adjustment);
 
-    static OP_Node* findOpInput(OP_Node *op, const char * const find_op_types[], bool include_me, const char* const  allowed_node_types[], bool *did_find_allowed_only, int rec_level = 0, UT_Set<OP_Node*> *already_visited=NULL);
+    static OP_Node* findOpInput(OP_Node *op, const char * const find_op_types[], bool include_me, const char* const  allowed_node_types[], bool *did_find_allowed_only, fpreal ftime, int rec_level = 0, UT_Set<OP_Node*> *already_visited=NULL);
     static bool findTimeDependentNode(OP_Node *op, const char * const ignored_node_types[], const char * const opt_more_types[], fpreal ftime, bool include_me, UT_Set<OP_Node*> *already_visited=NULL);
     static void setStandardTransforms(OP_Node* hd_node, FbxNode* fbx_node, ROP_FBXBaseNodeVisitInfo *node_info, fpreal bone_length, fpreal ftime, bool use_world_transform = false);
     static OP_Node* findNonInstanceTargetFromInstance(OP_Node* instance_ptr, fpreal ftime);
@@ -260,6 +264,17 @@ private:
 };
 typedef std::vector < ROP_FBXGDPCacheItem* > TGeomCacheItems;
 /********************************************************************************************************/
+/// What ROP_FBXUtil::getMaxPointsOverAnimation() learns from one frame, as
+/// recorded in its checkpoint.
+struct ROP_FBXPointCountRecord
+{
+    int32 myHasPrims;
+    int32 myIsParticles;
+    int32 myHasNonSurfaces;
+    int32 myNumUnconvertedPoints;
+    int32 myNumPoints;
+};
+/********************************************************************************************************/
 // NOTE: This class assumes frames are added in increasing order, and no frames are skipped.
 class ROP_FBXGDPCache
 {
@@ -283,8 +298,19 @@ public:
 
     int getNumFrames() { return myFrameItems.size(); }
 
+    /// Records the memory used by the frames stored so far, so that it shows
+    /// up in the export memory report. clearFrames() releases it from the
+    /// profiler that was current when it was first recorded, even if that
+    /// profiler is no longer current on the clearing thread.
+    void addMemoryUsage(int64 bytes);
+    int64 getMemoryUsage() const { return myMemoryUsage; }
+
 private:
     TGeomCacheItems myFrameItems;
+    int64 myMemoryUsage;
+    // Profiler charged by addMemoryUsage() and how much it was charged.
+    ROP_FBXProfiler* myMemoryProfiler;
+    int64 myProfiledMemoryUsage;
     fpreal myMinFrame;
     int myNumConstantPoints;
 